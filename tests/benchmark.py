@@ -0,0 +1,236 @@
+#!/usr/bin/env python
+"""Benchmark the actuator line source terms over mesh and element counts.
+
+Each tutorial case is copied to a scratch directory, its background mesh
+and number of elements per actuator line are scaled, phase timing is
+switched on, and the case is run for a fixed number of time steps. The
+mean time per step and calls per step of each timed phase, read from
+`postProcessing/timing`, are appended to a long format CSV keyed by the git
+commit, so scaling curves can be compared between commits.
+
+Usage:
+
+    python benchmark.py --mesh-scales 1 1.5 2 --element-scales 1 2 4
+    python benchmark.py --plot
+
+"""
+
+from __future__ import division, print_function
+import argparse
+import glob
+import os
+import re
+import shutil
+import subprocess
+import tempfile
+import time
+import pandas as pd
+from read_perf import load
+
+
+tests_dir = os.path.dirname(os.path.abspath(__file__))
+tutorials_dir = os.path.join(tests_dir, "..", "tutorials")
+
+cases = {"actuatorLine": "actuatorLine/simpleFoam",
+         "axialFlowTurbineAL": "axialFlowTurbineAL",
+         "crossFlowTurbineAL": "crossFlowTurbineAL"}
+
+default_output = os.path.join(tests_dir, "benchmarks", "results.csv")
+
+
+def git_commit():
+    """Return the short hash of the current commit, marked if modified."""
+    def git(*args):
+        return subprocess.check_output(["git"] + list(args),
+                                       cwd=tests_dir).decode().strip()
+    commit = git("rev-parse", "--short", "HEAD")
+    if git("status", "--porcelain", "--untracked-files=no"):
+        commit += "-dirty"
+    return commit
+
+
+def edit_file(fpath, pattern, repl, count=0):
+    """Substitute a regular expression in a file, failing if not found."""
+    with open(fpath) as f:
+        txt = f.read()
+    txt, n = re.subn(pattern, repl, txt, count=count)
+    if n == 0:
+        raise ValueError("{} not found in {}".format(pattern, fpath))
+    with open(fpath, "w") as f:
+        f.write(txt)
+
+
+def scale_mesh(case_dir, scale):
+    """Scale the number of cells of the background mesh in each direction."""
+    def scaled(match):
+        counts = [max(int(round(int(n)*scale)), 1) for n in match.groups()[1:]]
+        return match.group(1) + "({} {} {})".format(*counts)
+    edit_file(os.path.join(case_dir, "constant", "polyMesh", "blockMeshDict"),
+              r"(hex\s*\([^)]*\)\s*)\((\d+)\s+(\d+)\s+(\d+)\)", scaled)
+
+
+def scale_elements(case_dir, scale):
+    """Scale the number of elements of each actuator line."""
+    def scaled(match):
+        n = max(int(round(int(match.group(2))*scale)), 1)
+        return "{}{};".format(match.group(1), n)
+    edit_file(os.path.join(case_dir, "system", "fvOptions"),
+              r"(nElements\s+)(\d+);", scaled)
+
+
+def set_timing(case_dir):
+    """Switch on timing of every source, which turbines pass to their
+    actuator lines.
+    """
+    edit_file(os.path.join(case_dir, "system", "fvOptions"),
+              r"(\n([ \t]*)fieldNames[^\n]*\n)",
+              r"\1\2timing              on;\n")
+
+
+def set_steps(case_dir, nsteps):
+    """Run a fixed number of time steps, writing only at the end."""
+    fpath = os.path.join(case_dir, "system", "controlDict")
+    with open(fpath) as f:
+        txt = f.read()
+    deltat = float(re.search(r"\ndeltaT\s+([^;]+);", txt).group(1))
+    endtime = "{:g}".format(nsteps*deltat)
+    edit_file(fpath, r"\nendTime\s+[^;]+;",
+              "\nendTime         {};".format(endtime))
+    edit_file(fpath, r"\nwriteControl\s+[^;]+;",
+              "\nwriteControl    timeStep;")
+    edit_file(fpath, r"\nwriteInterval\s+[^;]+;",
+              "\nwriteInterval   {};".format(nsteps))
+
+
+def count_cells(case_dir):
+    """Read the number of cells from the mesh owner file header."""
+    with open(os.path.join(case_dir, "constant", "polyMesh", "owner")) as f:
+        header = f.read(4096)
+    return int(re.search(r"nCells:\s*(\d+)", header).group(1))
+
+
+def solver_clock_time(case_dir):
+    """Return the final clock time in the solver log."""
+    log = [f for f in glob.glob(os.path.join(case_dir, "log.*Foam"))][0]
+    with open(log) as f:
+        times = re.findall(r"ClockTime = ([\d.]+) s", f.read())
+    return float(times[-1])
+
+
+def load_timing(case_dir):
+    """Load the phase timings of all sources into a long format
+    `DataFrame` with the mean time and calls per step of each phase.
+    """
+    rows = []
+    files = glob.glob(os.path.join(case_dir, "postProcessing", "timing",
+                                   "*", "*"))
+    for fpath in sorted(files):
+        source = os.path.splitext(os.path.basename(fpath))[0]
+        df = load(fpath)
+        phases = [c[:-len("_time")] for c in df.columns
+                  if c.endswith("_time")]
+        for phase in phases:
+            rows.append(dict(source=source, phase=phase,
+                             time_per_step=df[phase + "_time"].mean(),
+                             calls_per_step=df[phase + "_calls"].mean()))
+    return pd.DataFrame(rows)
+
+
+def run_case(name, mesh_scale, element_scale, nsteps, parallel, work_dir):
+    """Run a scaled copy of a tutorial and return its timings."""
+    case_dir = os.path.join(work_dir, "{}-m{:g}-e{:g}".format(name, mesh_scale,
+                                                             element_scale))
+    if os.path.isdir(case_dir):
+        shutil.rmtree(case_dir)
+    shutil.copytree(os.path.join(tutorials_dir, cases[name]), case_dir)
+    scale_mesh(case_dir, mesh_scale)
+    scale_elements(case_dir, element_scale)
+    set_timing(case_dir)
+    set_steps(case_dir, nsteps)
+    cmd = ["./Allrun"]
+    if parallel:
+        cmd.append("-parallel")
+    print("Running {} with mesh scale {:g} and element scale {:g}".format(
+          name, mesh_scale, element_scale))
+    t0 = time.time()
+    subprocess.check_call(cmd, cwd=case_dir)
+    wall_time = time.time() - t0
+    df = load_timing(case_dir)
+    df["case"] = name
+    df["mesh_scale"] = mesh_scale
+    df["element_scale"] = element_scale
+    df["n_cells"] = count_cells(case_dir)
+    df["n_steps"] = nsteps
+    df["parallel"] = parallel
+    df["wall_time"] = wall_time
+    df["solver_clock_time"] = solver_clock_time(case_dir)
+    return df
+
+
+def plot(output, phase="addSup"):
+    """Plot the time per step of a phase against the scale factors, one
+    line per commit. Actuator lines of turbines never call `addSup` and are
+    left out, as their turbine includes their time.
+    """
+    import matplotlib.pyplot as plt
+    df = pd.read_csv(output)
+    df = df[df.phase == phase]
+    top_level = df[(df.phase == "addSup") & (df.calls_per_step > 0)]
+    df = df[df.source.isin(top_level.source.unique())]
+    ncases = len(df.case.unique())
+    fig, axes = plt.subplots(nrows=ncases, ncols=2, squeeze=False,
+                             figsize=(8, 3*ncases))
+    for row, (case, dfc) in zip(axes, df.groupby("case")):
+        for ax, x, other in zip(row, ["n_cells", "element_scale"],
+                                ["element_scale", "mesh_scale"]):
+            base = dfc[other].min()
+            for commit, dfcc in dfc[dfc[other] == base].groupby("commit"):
+                dfcc = dfcc.groupby(x).time_per_step.mean()
+                ax.plot(dfcc.index, dfcc.values, "-o", label=commit)
+            ax.set_xlabel(x)
+            ax.set_ylabel("{} time per step (s)".format(phase))
+            ax.set_title(case)
+            ax.legend(loc="best")
+    fig.tight_layout()
+    plt.show()
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("--cases", nargs="+", default=sorted(cases),
+                        choices=sorted(cases))
+    parser.add_argument("--mesh-scales", nargs="+", type=float,
+                        default=[1.0, 1.5, 2.0],
+                        help="Background mesh refinement in each direction")
+    parser.add_argument("--element-scales", nargs="+", type=float,
+                        default=[1.0, 2.0, 4.0],
+                        help="Multipliers of the elements per actuator line")
+    parser.add_argument("--steps", type=int, default=20,
+                        help="Number of time steps per run")
+    parser.add_argument("--parallel", action="store_true")
+    parser.add_argument("--work-dir", help="Directory for the scaled cases")
+    parser.add_argument("--output", default=default_output)
+    parser.add_argument("--plot", action="store_true",
+                        help="Plot the results instead of running")
+    args = parser.parse_args()
+
+    if args.plot:
+        plot(args.output)
+    else:
+        work_dir = args.work_dir or tempfile.mkdtemp(prefix="benchmark-")
+        commit = git_commit()
+        results = []
+        for name in args.cases:
+            for mesh_scale in args.mesh_scales:
+                for element_scale in args.element_scales:
+                    results.append(run_case(name, mesh_scale, element_scale,
+                                            args.steps, args.parallel,
+                                            work_dir))
+        df = pd.concat(results, ignore_index=True)
+        df["commit"] = commit
+        if os.path.isfile(args.output):
+            df = pd.concat([pd.read_csv(args.output), df], ignore_index=True)
+        elif not os.path.isdir(os.path.dirname(args.output)):
+            os.makedirs(os.path.dirname(args.output))
+        df.to_csv(args.output, index=False)
+        print("Results appended to", args.output)
@@ -0,0 +1,72 @@
+#!/usr/bin/env python
+"""Read turbinesFoam performance output files.
+
+Files ending in `.csv` are read as text. Files ending in `.bin` use the
+columnar binary layout of `performanceWriter`:
+
+    char[8]   magic "TFPERF\\0\\0"
+    int32     format version
+    int32     number of columns
+    {int32 length, char[length] name} per column
+    blocks of {int32 nRows, nRows float64 per column}
+
+Usage: `python read_perf.py postProcessing/turbines/0/turbine.bin`
+"""
+
+from __future__ import division, print_function
+import struct
+import sys
+import numpy as np
+import pandas as pd
+
+
+magic = b"TFPERF\0\0"
+
+
+def _read(f, fmt):
+    size = struct.calcsize(fmt)
+    data = f.read(size)
+    if len(data) < size:
+        raise EOFError
+    return struct.unpack(fmt, data)
+
+
+def load_binary(fpath):
+    """Load a binary performance file into a `DataFrame`."""
+    with open(fpath, "rb") as f:
+        if f.read(len(magic)) != magic:
+            raise IOError("{} is not a performance file".format(fpath))
+        version, ncols = _read(f, "=ii")
+        if version != 1:
+            raise IOError("Unsupported format version {}".format(version))
+        columns = []
+        for n in range(ncols):
+            length, = _read(f, "=i")
+            columns.append(f.read(length).decode())
+        blocks = []
+        while True:
+            try:
+                nrows, = _read(f, "=i")
+            except EOFError:
+                break
+            data = np.fromfile(f, dtype="=f8", count=nrows*ncols)
+            if data.size < nrows*ncols:
+                break  # Block truncated by a run still writing
+            blocks.append(data.reshape(ncols, nrows).T)
+    if blocks:
+        data = np.vstack(blocks)
+    else:
+        data = np.zeros((0, ncols))
+    return pd.DataFrame(data, columns=columns)
+
+
+def load(fpath):
+    """Load a CSV or binary performance file into a `DataFrame`."""
+    if fpath.endswith(".bin"):
+        return load_binary(fpath)
+    else:
+        return pd.read_csv(fpath)
+
+
+if __name__ == "__main__":
+    print(load(sys.argv[1]))
@@ -16,18 +16,11 @@ def plot_spanwise():
     """
     Plot spanwise distribution of angle of attack and relative velocity.
     """
-    elements_dir = "postProcessing/actuatorLineElements/0"
-    elements = os.listdir(elements_dir)
-    dfs = {}
-    z_H = np.zeros(len(elements))
-    urel = np.zeros(len(elements))
-    alpha_deg = np.zeros(len(elements))
-    for e in elements:
-        i = int(e.replace("foilElement", "").replace(".csv", ""))
-        df = pd.read_csv(os.path.join(elements_dir, e))
-        z_H[i] = df.z.iloc[-1]/H
-        urel[i] = df.rel_vel_mag.iloc[-1]/U_infty
-        alpha_deg[i] = df.alpha_deg.iloc[-1]
+    df = pd.read_csv("postProcessing/actuatorLineElements/0/foil.csv")
+    df = df[df.time == df.time.iloc[-1]].set_index("element").sort_index()
+    z_H = df.z.values/H
+    urel = df.rel_vel_mag.values/U_infty
+    alpha_deg = df.alpha_deg.values
     fig, ax = plt.subplots(nrows=1, ncols=2, figsize=(7.5, 3.25))
     ax[0].plot(z_H, alpha_deg)
     ax[0].set_ylabel(r"$\alpha$ (deg)")
@@ -97,7 +97,7 @@ def calcwake(t1=0.0):
             "y/R" : y_R, 
             "z/R" : z_R}
     
-def plot_al_perf(name="blade1"):
+def plot_al_perf(name="turbine.blade1"):
     df_turb = pd.read_csv("postProcessing/turbines/0/turbine.csv")
     df_turb = df_turb.drop_duplicates("time", keep="last")
     df = pd.read_csv("postProcessing/actuatorLines/0/{}.csv".format(name))
@@ -115,21 +115,14 @@ def plot_al_perf(name="blade1"):
     plt.tight_layout()
     
 def plot_blade_perf():
-    plot_al_perf("blade1")
+    plot_al_perf("turbine.blade1")
     
 def plot_spanwise():
-    elements_dir = "postProcessing/actuatorLineElements/0"
-    elements = os.listdir(elements_dir)
-    dfs = {}
-    r_R = np.zeros(len(elements))
-    fx = np.zeros(len(elements))
-    ft = np.zeros(len(elements))
-    for e in elements:
-        i = int(e.replace("blade1Element", "").replace(".csv", ""))
-        df = pd.read_csv(os.path.join(elements_dir, e))
-        r_R[i] = np.sqrt(df.y**2 + df.z**2).iloc[-1]/R
-        fx[i] = df.fx.iloc[-1]
-        ft[i] = np.sqrt(df.fy**2 + df.fz**2).iloc[-1]
+    df = pd.read_csv("postProcessing/actuatorLineElements/0/turbine.blade1.csv")
+    df = df[df.time == df.time.iloc[-1]].set_index("element").sort_index()
+    r_R = np.sqrt(df.y**2 + df.z**2).values/R
+    fx = df.Fx.values
+    ft = np.sqrt(df.Fy**2 + df.Fz**2).values
     fig, ax = plt.subplots(nrows=1, ncols=2, figsize=(7.5, 3.25))
     ax[0].plot(r_R, 2*ft/(U_infty**2*R))
     ax[0].set_ylabel(r"$F_\theta / (\rho R U_\infty^2)$")